@@ -0,0 +1,118 @@
+// $Id$
+//==============================================================================
+//!
+//! \file CentralDifferenceDriver.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author Knut Morten Okstad / SINTEF
+//!
+//! \brief Explicit central difference driver for elastodynamics problems.
+//!
+//==============================================================================
+
+#ifndef _CENTRAL_DIFFERENCE_DRIVER_H
+#define _CENTRAL_DIFFERENCE_DRIVER_H
+
+#include "MatVec.h"
+#include "TimeDomain.h"
+#include <iostream>
+
+class SIMoutput;
+class ElasticBase;
+class TiXmlElement;
+namespace utl { class LogStream; }
+
+
+/*!
+  \brief Driver for explicit time integration of elastodynamic problems.
+  \details The equations of motion are integrated with the central difference
+  scheme in velocity half-step form, using a lumped (diagonal) mass matrix.
+  Each time step then requires one assembly of the residual force vector only,
+  whereas no equation system is solved. The element loops of the assembly are
+  multi-threaded by the FE model, as for the implicit drivers.
+
+  The time step size is limited by the critical time step of the model, which
+  is estimated from the element stiffness and lumped mass matrices, i.e.,
+  from the element sizes and the material wave speeds.
+  The constrained DOFs follow the prescribed (possibly time-dependent)
+  displacements of the Dirichlet conditions.
+*/
+
+class CentralDifferenceDriver
+{
+public:
+  //! \brief The constructor initializes default solution parameters.
+  //! \param sim Reference to the spline FE model
+  explicit CentralDifferenceDriver(SIMoutput& sim);
+  //! \brief Empty destructor.
+  virtual ~CentralDifferenceDriver() {}
+
+  //! \brief Parses the solver parameters from an XML-element.
+  //! \param[in] elem The \a centraldifference XML element to parse
+  bool parse(const TiXmlElement* elem);
+  //! \brief Reads the solver parameters from the given input file.
+  bool read(const char* fileName);
+
+  //! \brief Overrides the stop time that was read from the input file.
+  void setStopTime(double t) { stopTime = t; }
+  //! \brief Defines the time step size to use, if less than critical.
+  void setTimeStep(double dt) { dtInput = dt; }
+
+  //! \brief Initializes the solution and computes the lumped mass.
+  bool initSolution();
+
+  //! \brief Invokes the main time stepping simulation loop.
+  //! \param os Output stream for result point values
+  //! \param[in] outPrec Number of digits after the decimal point in output
+  //! \param[in] inpFile Name of input file, for the VTF-file output.
+  //! If null, no VTF-file is written.
+  int solveProblem(utl::LogStream& os, std::streamsize outPrec = 3,
+                   const char* inpFile = nullptr);
+
+  //! \brief Advances the solution one time step.
+  bool advanceStep();
+
+  //! \brief Returns the current displacement vector.
+  const Vector& getDisplacement() const { return dis; }
+  //! \brief Returns the current velocity vector.
+  const Vector& getVelocity() const { return vel; }
+  //! \brief Returns the current acceleration vector.
+  const Vector& getAcceleration() const { return acc; }
+  //! \brief Returns the current time.
+  double getTime() const { return time.t; }
+  //! \brief Returns the time step size in use.
+  double getTimeStep() const { return time.dt; }
+  //! \brief Returns the estimated critical time step size.
+  double getCriticalTimeStep() const { return dtCrit; }
+
+protected:
+  //! \brief Assembles the residual forces and computes the accelerations.
+  bool computeAcceleration();
+  //! \brief Applies the prescribed displacements at the current time.
+  //! \param[in] dt Time step size, for the velocities of the constrained DOFs
+  bool applyDirichlet(double dt);
+  //! \brief Writes the current solution to VTF.
+  bool saveStep(int iStep, int& nBlock);
+
+private:
+  SIMoutput&   model; //!< The FE model to solve for
+  ElasticBase* elp;   //!< The elasticity integrand
+
+  double startTime; //!< Start time of the simulation
+  double stopTime;  //!< Stop time of the simulation
+  double dtInput;   //!< User-specified time step size (0 = use critical)
+  double dtSave;    //!< Time interval between result output
+  double safety;    //!< Safety factor on the critical time step
+  double alpha1;    //!< Mass-proportional damping coefficient
+  double dtCrit;    //!< Estimated critical time step size
+
+  TimeDomain time; //!< Current time and time step size
+  Vector mass;     //!< Lumped mass vector, in DOF-ordering
+  Vector dis;      //!< Displacements at current time
+  Vector vel;      //!< Velocities at current time
+  Vector vHalf;    //!< Velocities at previous half step
+  Vector acc;      //!< Accelerations at current time
+};
+
+#endif
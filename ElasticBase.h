@@ -15,6 +15,8 @@
 #define _ELASTIC_BASE_H
 
 #include "IntegrandBase.h"
+#include "MassLumping.h"
+#include "ElmMatCache.h"
 #include "Vec3.h"
 #include "BDF.h"
 
@@ -44,6 +46,29 @@ public:
   //! \brief Defines the number solution vectors.
   void setNoSolutions(size_t n) { nSV = n; }
 
+  //! \brief Defines the mass matrix lumping method.
+  void setMassLumping(MassLumping::Type type) { lumpMass = type; }
+  //! \brief Returns the mass matrix lumping method.
+  MassLumping::Type getMassLumping() const { return lumpMass; }
+
+  //! \brief Toggles estimation of the critical explicit time step size.
+  //! \details When enabled, the element stiffness matrices are computed in
+  //! the MASS_ONLY solution mode with mass lumping, and used to estimate the
+  //! critical time step of each element.
+  void setTimeStepEstimate(bool on) { dtEstim = on; }
+  //! \brief Returns the critical time step size of the assembled model.
+  //! \details Only available after a MASS_ONLY assembly with mass lumping
+  //! and time step estimation enabled. Returns zero otherwise.
+  double getCriticalTimeStep() const;
+
+  //! \brief Toggles caching of the element mass matrices.
+  //! \details The mass matrices depend on the reference configuration only,
+  //! as long as the mass density does not vary in time. When enabled, they
+  //! are therefore computed in the first assembly where they are needed, and
+  //! reused in subsequent assemblies. The cache is off by default, and should
+  //! only be enabled when both the geometry and the mass density are fixed.
+  void setMassCache(bool on) { MmCache.enable(on); MmFilled = false; }
+
   //! \brief Defines the solution mode before the element assembly is started.
   //! \param[in] mode The solution mode to use
   virtual void setMode(SIM::SolutionMode mode);
@@ -56,6 +81,11 @@ public:
   //! \param[in] i Index of the integration parameter to return
   virtual double getIntegrationPrm(unsigned short int i) const;
 
+  using IntegrandBase::initIntegration;
+  //! \brief Initializes the integrand with the number of integration points.
+  //! \param[in] nGp Total number of interior integration points
+  virtual void initIntegration(size_t nGp, size_t);
+
   //! \brief Advances the BDF time step scheme one step forward.
   void advanceStep(double dt, double dtn) { bdf.advanceStep(dt,dtn); }
 
@@ -78,6 +108,7 @@ public:
   //! \details This method is used to pass time step size parameters to the
   //! integrand in case of a dynamics simulation, where it is needed to compute
   //! the effective stiffness/mass matrix used in the Newton iterations.
+  //! The element mass matrix is also lumped here, if requested.
   virtual bool finalizeElement(LocalIntegral& elmInt,
                                const TimeDomain& time, size_t);
 
@@ -93,10 +124,20 @@ protected:
   unsigned short int eM;  //!< Index to element mass matrix
   unsigned short int eS;  //!< Index to element load vector
   unsigned short int iS;  //!< Index to element internal force vector
+  unsigned short int eMd; //!< Index to element lumped mass vector
   unsigned short int nSV; //!< Number of consequtive solution vectors in core
 
+  MassLumping::Type lumpMass; //!< Mass matrix lumping method
+
+  bool dtEstim; //!< If \e true, estimate the critical explicit time step
+  //! Critical time step of each element, by first integration point
+  std::vector<double> dtElm;
+
   TimeIntegration::BDFD2 bdf; //!< BDF time discretization parameters
 
+  ElmMatCache MmCache;  //!< Cached element mass matrices
+  bool        MmFilled; //!< If \e true, the mass matrix cache is filled
+
   //! \brief Newmark time integration parameters.
   //! \details The interpretation of each parameter
   //! depends on the actual simulator drivers, as follows: <UL>
@@ -0,0 +1,348 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ElasticKernels.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author Knut Morten Okstad / SINTEF
+//!
+//! \brief Fixed-size integration point kernels for continuum elasticity.
+//!
+//==============================================================================
+
+#ifndef _ELASTIC_KERNELS_H
+#define _ELASTIC_KERNELS_H
+
+#include "MatVec.h"
+#include "Vec3.h"
+#include "Tensor.h"
+
+#ifndef epsR
+//! \brief Zero tolerance for the radial coordinate.
+#define epsR 1.0e-16
+#endif
+
+
+/*!
+  \brief Integration point kernels specialized on the spatial dimension.
+  \details The functions in this namespace are templated on the number of
+  spatial dimensions \a nsd and on whether the problem is axi-symmetric or not,
+  such that all inner loops have compile-time bounds and all temporaries can be
+  allocated on the stack. The element matrices are formed directly from the
+  basis function gradients in \a nsd &times; \a nsd blocks, i.e., without
+  establishing the sparse strain-displacement matrix explicitly.
+*/
+
+namespace ElasticKernels
+{
+  //! \brief Number of stress/strain components.
+  template<unsigned short int nsd, bool axS> struct Voigt
+  {
+    static const size_t nst = axS ? 4 : nsd*(nsd+1)/2; //!< Number of components
+  };
+
+  //! \brief Returns the Voigt index of the strain component (i,j).
+  template<unsigned short int nsd>
+  inline size_t voigt(unsigned short int i, unsigned short int j)
+  {
+    if (i == j)
+      return i;
+    else if (nsd == 2)
+      return 2;
+
+    return i+j == 1 ? 3 : (i+j == 3 ? 4 : 5);
+  }
+
+  /*!
+    \brief Forms the strain-displacement block of basis function \a a.
+    \param[out] B The \a nst &times; \a nsd block of the B-matrix
+    \param[in] N Basis function values at current point
+    \param[in] dNdX Basis function gradients at current point
+    \param[in] a 1-based basis function index
+    \param[in] r Radial coordinate of current point (axi-symmetric only)
+
+    \details The component ordering is identical to that of
+    Elasticity::formBmatrix.
+  */
+  template<unsigned short int nsd, bool axS>
+  inline void formB(double B[][nsd], const Vector& N, const Matrix& dNdX,
+                    size_t a, double r)
+  {
+    const size_t nst = Voigt<nsd,axS>::nst;
+    for (size_t s = 0; s < nst; s++)
+      for (unsigned short int i = 0; i < nsd; i++)
+        B[s][i] = 0.0;
+
+    if (axS)
+    {
+      B[0][0] = dNdX(a,1);
+      B[1][1] = dNdX(a,2);
+      B[2][0] = r <= epsR ? dNdX(a,1) : N(a)/r;
+      B[3][0] = dNdX(a,2);
+      B[3][1] = dNdX(a,1);
+    }
+    else if (nsd == 2)
+    {
+      B[0][0] = dNdX(a,1);
+      B[1][1] = dNdX(a,2);
+      B[2][0] = dNdX(a,2);
+      B[2][1] = dNdX(a,1);
+    }
+    else if (nsd == 3)
+    {
+      B[0][0] = dNdX(a,1);
+      B[1][1] = dNdX(a,2);
+      B[2][2] = dNdX(a,3);
+      B[3][0] = dNdX(a,2);
+      B[3][1] = dNdX(a,1);
+      B[4][1] = dNdX(a,3);
+      B[4][2] = dNdX(a,2);
+      B[5][0] = dNdX(a,3);
+      B[5][2] = dNdX(a,1);
+    }
+    else
+      B[0][0] = dNdX(a,1);
+  }
+
+  /*!
+    \brief Integrates the material stiffness matrix at current point.
+    \param EK Element matrix to receive the stiffness contributions
+    \param[in] C Constitutive matrix at current point
+    \param[in] N Basis function values at current point
+    \param[in] dNdX Basis function gradients at current point
+    \param[in] r Radial coordinate of current point (axi-symmetric only)
+    \param[in] detJW Jacobian determinant times integration point weight
+
+    \details Computes \f$ K_{ab} \mathrel{+}= B_a^T C B_b |J|w \f$ for all
+    basis function pairs, exploiting the symmetry of \a C when present.
+  */
+  template<unsigned short int nsd, bool axS>
+  void stiffness(Matrix& EK, const Matrix& C, const Vector& N,
+                 const Matrix& dNdX, double r, double detJW)
+  {
+    const size_t nst = Voigt<nsd,axS>::nst;
+    const size_t nen = dNdX.rows();
+
+    size_t s, t;
+    unsigned short int i, j;
+    double D[nst][nst];
+    bool symm = true;
+    for (s = 0; s < nst; s++)
+      for (t = 0; t < nst; t++)
+      {
+        D[s][t] = C(s+1,t+1)*detJW;
+        if (t < s && C(s+1,t+1) != C(t+1,s+1))
+          symm = false;
+      }
+
+    double Ba[nst][nsd], Bb[nst][nsd], DBb[nst][nsd];
+    for (size_t b = 1; b <= nen; b++)
+    {
+      formB<nsd,axS>(Bb,N,dNdX,b,r);
+      for (s = 0; s < nst; s++)
+        for (j = 0; j < nsd; j++)
+        {
+          DBb[s][j] = 0.0;
+          for (t = 0; t < nst; t++)
+            DBb[s][j] += D[s][t]*Bb[t][j];
+        }
+
+      for (size_t a = 1; a <= (symm ? b : nen); a++)
+      {
+        formB<nsd,axS>(Ba,N,dNdX,a,r);
+        for (i = 0; i < nsd; i++)
+          for (j = 0; j < nsd; j++)
+          {
+            double kab = 0.0;
+            for (s = 0; s < nst; s++)
+              kab += Ba[s][i]*DBb[s][j];
+            EK(nsd*(a-1)+1+i,nsd*(b-1)+1+j) += kab;
+            if (symm && a < b)
+              EK(nsd*(b-1)+1+j,nsd*(a-1)+1+i) += kab;
+          }
+      }
+    }
+  }
+
+  /*!
+    \brief Integrates the material stiffness matrix over all points of an element.
+    \param EK Element matrix to receive the stiffness contributions
+    \param[in] D Constitutive matrices times integration point volume,
+    where \a D[(s*nst+t)*nPt+q] is component (s,t) at point \a q
+    \param[in] dNdX Basis function gradients, one row per point
+    \param[in] symm If \e true, all constitutive matrices are symmetric
+
+    \details The innermost loops run over the integration points with unit
+    stride, such that they can be vectorized by the compiler.
+  */
+  template<unsigned short int nsd>
+  void stiffnessBatch(Matrix& EK, const RealArray& D, const Matrix& dNdX,
+                      bool symm)
+  {
+    const size_t nst = Voigt<nsd,false>::nst;
+    const size_t nPt = dNdX.rows();
+    const size_t nen = dNdX.cols()/nsd;
+    if (nPt == 0) return;
+
+    unsigned short int i, j, m, n;
+    size_t q;
+    RealArray Z(nsd*nsd*nsd*nPt);
+    for (size_t b = 0; b < nen; b++)
+    {
+      // Z_imj = sum_n C(v(i,m),v(j,n))*dNb/dX_n
+      for (i = 0; i < nsd; i++)
+        for (m = 0; m < nsd; m++)
+          for (j = 0; j < nsd; j++)
+          {
+            double* z = Z.data() + ((i*nsd+m)*nsd+j)*nPt;
+            for (q = 0; q < nPt; q++)
+              z[q] = 0.0;
+            for (n = 0; n < nsd; n++)
+            {
+              const double* c = D.data() + (voigt<nsd>(i,m)*nst +
+                                            voigt<nsd>(j,n))*nPt;
+              const double* dNb = &dNdX(1,b+1+nen*n);
+              for (q = 0; q < nPt; q++)
+                z[q] += c[q]*dNb[q];
+            }
+          }
+
+      // K_ab^ij = sum_m dNa/dX_m * Z_imj
+      for (size_t a = 0; a <= (symm ? b : nen-1); a++)
+        for (i = 0; i < nsd; i++)
+          for (j = 0; j < nsd; j++)
+          {
+            double kab = 0.0;
+            for (m = 0; m < nsd; m++)
+            {
+              const double* dNa = &dNdX(1,a+1+nen*m);
+              const double* z = Z.data() + ((i*nsd+m)*nsd+j)*nPt;
+              for (q = 0; q < nPt; q++)
+                kab += dNa[q]*z[q];
+            }
+            EK(nsd*a+1+i,nsd*b+1+j) += kab;
+            if (symm && a < b)
+              EK(nsd*b+1+j,nsd*a+1+i) += kab;
+          }
+    }
+  }
+
+  /*!
+    \brief Integrates the geometric stiffness matrix at current point.
+    \param EM Element matrix to receive the stiffness contributions
+    \param[in] N Basis function values at current point
+    \param[in] dNdX Basis function gradients at current point
+    \param[in] kgrr Hoop stress over radius squared (axi-symmetric only)
+    \param[in] sigma Stress tensor at current point
+    \param[in] detJW Jacobian determinant times integration point weight
+  */
+  template<unsigned short int nsd>
+  void geoStiffness(Matrix& EM, const Vector& N, const Matrix& dNdX,
+                    double kgrr, const Tensor& sigma, double detJW)
+  {
+    const size_t nen = dNdX.rows();
+
+    unsigned short int i, j;
+    double S[nsd][nsd], SdNb[nsd];
+    for (i = 0; i < nsd; i++)
+      for (j = 0; j < nsd; j++)
+        S[i][j] = sigma(i+1,j+1)*detJW;
+
+    for (size_t b = 1; b <= nen; b++)
+    {
+      for (i = 0; i < nsd; i++)
+      {
+        SdNb[i] = 0.0;
+        for (j = 0; j < nsd; j++)
+          SdNb[i] += S[i][j]*dNdX(b,j+1);
+      }
+
+      for (size_t a = 1; a <= b; a++)
+      {
+        double kg = 0.0;
+        for (i = 0; i < nsd; i++)
+          kg += dNdX(a,i+1)*SdNb[i];
+        for (i = 1; i <= nsd; i++)
+          EM(nsd*(a-1)+i,nsd*(b-1)+i) += kg;
+
+        if (kgrr > 0.0)
+          EM(nsd*(a-1)+1,nsd*(b-1)+1) += N(a)*kgrr*N(b)*detJW;
+
+        if (a < b)
+        {
+          for (i = 1; i <= nsd; i++)
+            EM(nsd*(b-1)+i,nsd*(a-1)+i) += kg;
+
+          if (kgrr > 0.0)
+            EM(nsd*(b-1)+1,nsd*(a-1)+1) += N(a)*kgrr*N(b)*detJW;
+        }
+      }
+    }
+  }
+
+  /*!
+    \brief Integrates the consistent mass matrix at current point.
+    \param EM Element matrix to receive the mass contributions
+    \param[in] N Basis function values at current point
+    \param[in] rhow Mass density times integration point volume
+  */
+  template<unsigned short int nsd>
+  void mass(Matrix& EM, const Vector& N, double rhow)
+  {
+    const size_t nen = N.size();
+    for (size_t b = 1; b <= nen; b++)
+    {
+      double rhoNb = rhow*N(b);
+      for (size_t a = 1; a <= b; a++)
+      {
+        double mab = N(a)*rhoNb;
+        for (unsigned short int i = 1; i <= nsd; i++)
+        {
+          EM(nsd*(a-1)+i,nsd*(b-1)+i) += mab;
+          if (a < b)
+            EM(nsd*(b-1)+i,nsd*(a-1)+i) += mab;
+        }
+      }
+    }
+  }
+
+  /*!
+    \brief Integrates the body force vector at current point.
+    \param ES Element vector to receive the body force contributions
+    \param[in] N Basis function values at current point
+    \param[in] f Body force times integration point volume
+  */
+  template<unsigned short int nsd>
+  void bodyForce(Vector& ES, const Vector& N, const Vec3& f)
+  {
+    const size_t nen = N.size();
+    double* es = ES.ptr();
+    for (size_t a = 0; a < nen; a++, es += nsd)
+      for (unsigned short int i = 0; i < nsd; i++)
+        es[i] += f[i]*N[a];
+  }
+
+  /*!
+    \brief Evaluates the energy product of two stress vectors.
+    \param[in] Ci Inverse constitutive matrix at current point
+    \param[in] a First stress vector
+    \param[in] b Second stress vector
+    \return \f$ a^T C^{-1} b \f$
+  */
+  template<size_t nst>
+  inline double energy(const double Ci[][nst], const double* a, const double* b)
+  {
+    double result = 0.0;
+    for (size_t s = 0; s < nst; s++)
+    {
+      double Cib = 0.0;
+      for (size_t t = 0; t < nst; t++)
+        Cib += Ci[s][t]*b[t];
+      result += a[s]*Cib;
+    }
+    return result;
+  }
+}
+
+#endif
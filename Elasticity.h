@@ -23,6 +23,59 @@ class ElmMats;
 class TiXmlElement;
 
 
+/*!
+  \brief Class containing the integration point data of an element.
+  \details The data is stored in structure-of-arrays form, i.e., each basis
+  function value and gradient component is stored contiguously over the
+  integration points of the element, to allow kernels that vectorize across
+  the points. The points are appended one by one using the \a add method,
+  and the arrays are established by the \a pack method.
+*/
+
+class ItgPtBatch
+{
+public:
+  //! \brief The constructor initializes the batch as empty.
+  ItgPtBatch() : nen(0), nsd(0) {}
+
+  //! \brief Appends an integration point to the batch.
+  //! \param[in] fe Finite element data of the integration point
+  //! \param[in] X Cartesian coordinates of the integration point
+  //!
+  //! \details If \a X is a Vec4 object, its time and point index are stored
+  //! as well, such that the point can be replayed as given.
+  void add(const FiniteElement& fe, const Vec3& X);
+  //! \brief Establishes the structure-of-arrays representation of the batch.
+  void pack();
+  //! \brief Clears the batch.
+  void clear();
+
+  //! \brief Extracts the data of an integration point from the batch.
+  //! \param[in] q 0-based point index
+  //! \param fe Finite element data of the point
+  void getPoint(size_t q, FiniteElement& fe) const;
+
+  //! \brief Returns the number of integration points in the batch.
+  size_t size() const { return detJxW.size(); }
+  //! \brief Returns the number of basis functions of the element.
+  size_t getNoBasis() const { return nen; }
+
+  Matrix    N;       //!< Basis function values, one row per point
+  Matrix    dNdX;    //!< Basis function gradients, one row per point
+  RealArray detJxW;  //!< Jacobian determinant times weight at each point
+  std::vector<Vec4> X; //!< Cartesian coordinates and time of each point
+  Vec3Vec   Xi;      //!< Element-local parameters of each point
+  Vec3Vec   U;       //!< Spline parameters of each point
+  std::vector<size_t> iGP; //!< Global integration point counters
+
+private:
+  size_t    nen;     //!< Number of basis functions
+  size_t    nsd;     //!< Number of spatial dimensions
+  RealArray myN;     //!< Point-wise basis function values
+  RealArray mydNdX;  //!< Point-wise basis function gradients
+};
+
+
 /*!
   \brief Base class representing the integrand of elasticity problems.
   \details Implements common features for linear and nonlinear elasticity
@@ -76,6 +129,23 @@ public:
   //! \brief Defines the local coordinate system for stress output.
   void setLocalSystem(LocalSystem* cs) { locSys = cs; }
 
+  //! \brief Toggles recording of boundary traction values for visualization.
+  void setTractionOutput(bool on) { tracOut = on; }
+
+  //! \brief Defines the caching of external load function values.
+  //! \param[in] mode \a 'T' to reuse cached loads at the same time only,
+  //! \a 'C' to reuse them always (time-independent loads), \a 'S' to scale
+  //! them by the given time function, or 0 to switch off the caching
+  //! \param[in] scale Time multiplier of all external loads, for mode \a 'S'
+  //! \details The body force and boundary traction functions are then
+  //! evaluated only once per integration point, as long as the cached values
+  //! are valid. Only the function values are cached. The element load vectors
+  //! are still integrated in each assembly, and thermal loads are not cached.
+  //! This is only valid when the loads do not depend on the deformation.
+  //! In the modes \a 'C' and \a 'S', points where the load turns out to vary
+  //! differently in time are re-evaluated at each new time, as in mode \a 'T'.
+  void setLoadCache(char mode, ScalarFunc* scale = nullptr);
+
   using ElasticBase::initIntegration;
   //! \brief Initializes the integrand with the number of integration points.
   //! \param[in] nGp Total number of interior integration points
@@ -94,6 +164,17 @@ public:
   virtual LocalIntegral* getLocalIntegral(size_t nen, size_t,
                                           bool neumann) const;
 
+  //! \brief Evaluates the integrand at all interior points of an element.
+  //! \param elmInt The local integral object to receive the contributions
+  //! \param fe Finite element data of the element (the point-wise data is
+  //! overwritten by the data of each point)
+  //! \param[in] batch Integration point data of the element
+  //!
+  //! \details This method evaluates the \a evalInt method for each point of
+  //! the batch. Sub-classes may reimplement it to evaluate an element at once.
+  virtual bool evalIntBatch(LocalIntegral& elmInt, FiniteElement& fe,
+                            const ItgPtBatch& batch) const;
+
   //! \brief Returns whether this norm has explicit boundary contributions.
   virtual bool hasBoundaryTerms() const { return true; }
 
@@ -145,6 +226,15 @@ public:
 
   //! \brief Evaluates the boundary traction field (if any) at specified point.
   Vec3 getTraction(const Vec3& X, const Vec3& n) const;
+  //! \brief Evaluates the boundary traction field, using the load cache.
+  //! \param[in] X Cartesian coordinates of current point
+  //! \param[in] n Boundary normal vector at current point
+  //! \param[in] iP Global boundary integration point counter
+  Vec3 getTraction(const Vec3& X, const Vec3& n, size_t iP) const;
+  //! \brief Evaluates the body force field, using the load cache.
+  //! \param[in] X Cartesian coordinates of current point
+  //! \param[in] iP Global integration point counter
+  Vec3 getBodyforce(const Vec3& X, size_t iP) const;
   //! \brief Evaluates the body force field (if any) at specified point.
   virtual Vec3 getBodyforce(const Vec3& X) const;
   //! \brief Returns whether an external load is defined.
@@ -193,7 +283,7 @@ public:
   typedef std::pair<Vec3,double> PointValue; //!< Convenience type
 
   //! \brief Returns a pointer to the max values for external update.
-  std::vector<PointValue>* getMaxVals() const { return &maxVal; }
+  std::vector<PointValue>* getMaxVals() const;
 
   //! \brief Prints out the maximum secondary solution values to the log stream.
   //! \param[in] precision Number of digits after the decimal point
@@ -233,10 +323,11 @@ protected:
   //! \brief Calculates integration point body force vector contributions.
   //! \param ES Element vector to receive the body force contributions
   //! \param[in] N Basis function values at current point
+  //! \param[in] iP Global integration point counter
   //! \param[in] X Cartesian coordinates of current point
   //! \param[in] detJW Jacobian determinant times integration point weight
   void formBodyForce(Vector& ES, const Vector& N,
-		     const Vec3& X, double detJW) const;
+		     size_t iP, const Vec3& X, double detJW) const;
 
   //! \brief Calculates the strain-displacement matrix.
   //! \param[in] Bmat The strain-displacement matrix
@@ -289,6 +380,18 @@ public:
   //! \brief Returns the tensile energy array (interface for fracture problems).
   virtual const RealArray* getTensileEnergy() const { return nullptr; }
 
+  //! \brief Resets the maximum result values.
+  //! \param[in] nComp Number of result components
+  void resetMaxVals(size_t nComp);
+  //! \brief Merges the thread-local maximum result values into \ref maxVal.
+  //! \details The threads are processed in a fixed order, such that the
+  //! result is independent of which thread finished first.
+  void mergeMaxVals() const;
+  //! \brief Merges the thread-local principal stress directions into the
+  //! internal buffer, in result point order.
+  //! \param[in] nPt Number of result points
+  bool mergePrincipalDirs(size_t nPt) const;
+
 protected:
   // Physical properties
   Material*     material; //!< Material data and constitutive relation
@@ -301,6 +404,50 @@ protected:
   mutable std::vector<PointValue> maxVal;  //!< Maximum result values
   mutable std::vector<Vec3Pair>   tracVal; //!< Traction field point values
 
+  //! Thread-local maximum result values, merged into \ref maxVal on request
+  mutable std::vector< std::vector<PointValue> > thrMaxVal;
+  //! \brief Principal stress directions at a result point, with its index.
+  typedef std::pair<size_t,Vec3Pair> PointDirs;
+  //! Thread-local principal stress directions, merged into \ref pDirBuf
+  mutable std::vector< std::vector<PointDirs> > thrPDir;
+
+  bool tracOut; //!< If \e true, record boundary tractions for visualization
+
+  //! \brief Struct with an external load function value cached at a point.
+  struct CachedLoad
+  {
+    Vec3        val;   //!< The load value
+    Vec3        pred;  //!< Predicted load value, to be verified
+    double      t;     //!< Time of the load evaluation
+    const void* key;   //!< The load function that was evaluated
+    //! \brief Cache state: 0 = empty, \a 'N' = not verified,
+    //! \a 'P' = verification pending, \a 'V' = verified time variation,
+    //! \a 'T' = time-dependent load (reused at the same time only)
+    char        state;
+    //! \brief Default constructor.
+    CachedLoad() : t(0.0), key(nullptr), state(0) {}
+  };
+
+  //! \brief Returns a cached load value, if still valid at time \a t.
+  //! \param c The cached load value
+  //! \param[in] t Current time
+  //! \param[in] key The load function to evaluate
+  //! \param[out] val The (scaled) load value
+  bool getCachedLoad(CachedLoad& c, double t, const void* key,
+                     Vec3& val) const;
+  //! \brief Stores a new load evaluation in the cache.
+  //! \param c The cached load value
+  //! \param[in] t Current time
+  //! \param[in] key The load function that was evaluated
+  //! \param[in] val The evaluated load value
+  void setCachedLoad(CachedLoad& c, double t, const void* key,
+                     const Vec3& val) const;
+
+  char        loadCache; //!< Load caching mode
+  ScalarFunc* loadScale; //!< Time multiplier of the cached external loads
+  mutable std::vector<CachedLoad> bodyCache; //!< Cached body forces
+  mutable std::vector<CachedLoad> tracCache; //!< Cached boundary tractions
+
   unsigned short int nDF; //!< Dimension on deformation gradient (2 or 3)
   bool       axiSymmetry; //!< \e true if the problem is axi-symmetric
   double           gamma; //!< Numeric stabilization parameter
@@ -369,6 +516,23 @@ public:
   virtual bool hasElementContributions(size_t i, size_t j) const;
 
 private:
+  //! \brief Integrates the stress-based norms at current point.
+  //! \param pnorm The element norms to receive the contributions
+  //! \param[in] fe Finite element data of current integration point
+  //! \param[in] Cinv Inverse constitutive matrix at current point
+  //! \param[in] sigmah Finite element stress vector at current point
+  //! \param[in] sigma Analytical stress vector at current point (optional)
+  //! \param[in] planeStrain If \e true, skip the projected sigma_zz component
+  //! \param[in] detJW Jacobian determinant times integration point weight
+  //!
+  //! \details The stress vectors are stored in fixed-size arrays, such that
+  //! no heap allocations are performed for the individual norm groups.
+  template<size_t nst>
+  void evalStressNorms(ElmNorm& pnorm, const FiniteElement& fe,
+                       const Matrix& Cinv, const Vector& sigmah,
+                       const Vector* sigma, bool planeStrain,
+                       double detJW) const;
+
   STensorFunc* anasol; //!< Analytical stress field
 };
 
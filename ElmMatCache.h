@@ -0,0 +1,80 @@
+// $Id$
+//==============================================================================
+//!
+//! \file ElmMatCache.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author Knut Morten Okstad / SINTEF
+//!
+//! \brief Cache of element matrices between assembly passes.
+//!
+//==============================================================================
+
+#ifndef _ELM_MAT_CACHE_H
+#define _ELM_MAT_CACHE_H
+
+#include "MatVec.h"
+
+
+/*!
+  \brief Class caching one matrix per element between assembly passes.
+  \details The elements are identified by the global integration point counter
+  of their first integration point, which is unique for a given quadrature
+  rule. The cache is sized before the element loop starts, such that elements
+  can be stored concurrently from multiple threads without locking.
+*/
+
+class ElmMatCache
+{
+public:
+  //! \brief The constructor initializes an empty and disabled cache.
+  ElmMatCache() : enabled(false), valid(false) {}
+
+  //! \brief Enables or disables the cache.
+  void enable(bool on) { enabled = on; if (!on) this->clear(); }
+  //! \brief Returns \e true if the cache is enabled.
+  bool isEnabled() const { return enabled; }
+
+  //! \brief Clears the cache contents.
+  void clear() { cache.clear(); valid = false; }
+  //! \brief Prepares the cache for the given number of integration points.
+  //! \details The existing contents is kept if the size is unchanged.
+  //! \return \e true if the existing contents was kept
+  bool init(size_t nGp)
+  {
+    if (!enabled || nGp == cache.size()) return enabled;
+    cache.clear();
+    cache.resize(nGp);
+    valid = false;
+    return false;
+  }
+
+  //! \brief Marks the cache contents as complete, or not.
+  void setValid(bool ok) { valid = ok && enabled && !cache.empty(); }
+  //! \brief Returns \e true if the cache contents is complete.
+  bool isValid() const { return valid; }
+
+  //! \brief Stores the matrix of an element.
+  //! \param[in] iGP Global integration point counter of first element point
+  //! \param[in] A The element matrix to store
+  void store(size_t iGP, const Matrix& A)
+  {
+    if (enabled && iGP < cache.size()) cache[iGP] = A;
+  }
+
+  //! \brief Returns the cached matrix of an element, if any.
+  //! \param[in] iGP Global integration point counter of first element point
+  const Matrix* get(size_t iGP) const
+  {
+    if (!valid || iGP >= cache.size() || cache[iGP].empty()) return nullptr;
+    return &cache[iGP];
+  }
+
+private:
+  std::vector<Matrix> cache; //!< The cached element matrices
+  bool enabled; //!< If \e true, element matrices are stored
+  bool valid;   //!< If \e true, the cache contents is complete
+};
+
+#endif
@@ -39,7 +39,8 @@ public:
   LinIsotropic(double E, double v = 0.0, double densty = 0.0,
                bool ps = false, bool ax = false)
     : Efunc(nullptr), Efield(nullptr), Emod(E), nu(v), rho(densty),
-      Afunc(nullptr), alpha(0.0), planeStress(ps), axiSymmetry(ax) {}
+      Afunc(nullptr), alpha(0.0), planeStress(ps), axiSymmetry(ax)
+  { this->initCmatrix(); }
   //! \brief Constructor initializing the material parameters.
   //! \param[in] E Young's modulus (spatial function)
   //! \param[in] v Poisson's ratio
@@ -105,6 +106,18 @@ public:
   virtual bool evaluate(double& lambda, double& mu,
                         const FiniteElement& fe, const Vec3& X) const;
 
+  //! \brief Returns \e true if the stiffness is constant in space.
+  bool hasConstantStiffness() const { return !Efunc && !Efield && Cvalid; }
+  //! \brief Returns the precomputed constitutive matrix for constant stiffness.
+  //! \param[in] nsd Number of spatial dimensions (1, 2 or 3)
+  //! \param[in] inverse If \e true, return the inverse constitutive matrix
+  //!
+  //! \details Only valid if hasConstantStiffness() returns \e true.
+  const Matrix& getCmatrix(size_t nsd, bool inverse = false) const
+  {
+    return Cmat[inverse ? 1 : 0][nsd-1];
+  }
+
   //! \brief Returns the function, if any, describing the stiffness variation.
   const RealFunc* getEfunc() const { return Efunc; }
   //! \brief Returns the field, if any, describing the stiffness variation.
@@ -125,6 +138,21 @@ protected:
   double conductivity;  //!< Thermal conductivity (constant)
   bool   planeStress;   //!< Plane stress/strain option for 2D problems
   bool   axiSymmetry;   //!< Axi-symmetric option
+
+  //! \brief Precomputes the constitutive matrices for constant stiffness.
+  //! \details Must be invoked whenever the material parameters are changed.
+  void initCmatrix();
+
+private:
+  //! \brief Calculates the (inverse) constitutive matrix.
+  //! \param[out] C The constitutive matrix
+  //! \param[in] E Young's modulus
+  //! \param[in] nsd Number of spatial dimensions
+  //! \param[in] inverse If \e true, calculate the inverse constitutive matrix
+  bool formCmatrix(Matrix& C, double E, size_t nsd, bool inverse) const;
+
+  Matrix Cmat[2][3]; //!< Constitutive matrices (direct and inverse) per nsd
+  bool   Cvalid;     //!< If \e true, the precomputed matrices are valid
 };
 
 #endif
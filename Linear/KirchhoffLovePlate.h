@@ -15,6 +15,7 @@
 #define _KIRCHHOFF_LOVE_PLATE_H
 
 #include "IntegrandBase.h"
+#include "MassLumping.h"
 #include "Vec3.h"
 
 class LocalSystem;
@@ -58,6 +59,9 @@ public:
   //! \brief Defines the local coordinate system for stress resultant output.
   void setLocalSystem(LocalSystem* cs) { locSys = cs; }
 
+  //! \brief Defines the mass matrix lumping method.
+  void setMassLumping(MassLumping::Type type) { lumpMass = type; }
+
   //! \brief Defines which FE quantities are needed by the integrand.
   virtual int getIntegrandType() const { return SECOND_DERIVATIVES; }
 
@@ -87,6 +91,14 @@ public:
   virtual bool evalBou(LocalIntegral& elmInt, const FiniteElement& fe,
 		       const Vec3& X, const Vec3& normal) const;
 
+  using IntegrandBase::finalizeElement;
+  //! \brief Finalizes the element matrices after the numerical integration.
+  //! \param elmInt The local integral object to receive the contributions
+  //!
+  //! \details The element mass matrix is lumped here, if requested.
+  virtual bool finalizeElement(LocalIntegral& elmInt,
+                               const TimeDomain&, size_t);
+
   using IntegrandBase::evalSol;
   //! \brief Evaluates the secondary solution at a result point.
   //! \param[out] s Array of solution field values at current point
@@ -186,6 +198,8 @@ protected:
   double    thickness; //!< Plate thickness
   double    gravity;   //!< Gravitation constant
 
+  MassLumping::Type lumpMass; //!< Mass matrix lumping method
+
   LocalSystem* locSys;  //!< Local coordinate system for result output
   RealFunc*    presFld; //!< Pointer to pressure field
 
@@ -15,6 +15,7 @@
 #define _LINEAR_ELASTICITY_H
 
 #include "Elasticity.h"
+#include "ElmMatCache.h"
 
 
 /*!
@@ -42,6 +43,14 @@ public:
   //! \param[in] mode The solution mode to use
   virtual void setMode(SIM::SolutionMode mode);
 
+  using Elasticity::getLocalIntegral;
+  //! \brief Returns a local integral container for the given element.
+  //! \param[in] nen Number of nodes on element
+  //! \param[in] iEl Global element number
+  //! \param[in] neumann Whether or not we are assembling Neumann BCs
+  virtual LocalIntegral* getLocalIntegral(size_t nen, size_t iEl,
+                                          bool neumann) const;
+
   //! \brief Initializes the integrand with the number of integration points.
   //! \param[in] nGp Total number of interior integration points
   //! \param[in] nBp Total number of boundary integration points
@@ -71,9 +80,55 @@ public:
   virtual bool evalInt(LocalIntegral& elmInt, const FiniteElement& fe,
                        const Vec3& X, const Vec3& normal) const;
 
+  using Elasticity::evalBou;
+  //! \brief Evaluates the integrand at a boundary point.
+  //! \param elmInt The local integral object to receive the contributions
+  //! \param[in] fe Finite element data of current integration point
+  //! \param[in] X Cartesian coordinates of current integration point
+  //! \param[in] normal Boundary normal vector at current integration point
+  virtual bool evalBou(LocalIntegral& elmInt, const FiniteElement& fe,
+                       const Vec3& X, const Vec3& normal) const;
+
+  //! \brief Evaluates the integrand at all interior points of an element.
+  //! \param elmInt The local integral object to receive the contributions
+  //! \param fe Finite element data of the element
+  //! \param[in] batch Integration point data of the element
+  //!
+  //! \details The material stiffness matrix is integrated over all points at
+  //! once, using sum factorization if enabled and applicable.
+  virtual bool evalIntBatch(LocalIntegral& elmInt, FiniteElement& fe,
+                            const ItgPtBatch& batch) const;
+
+  using ElasticBase::finalizeElement;
+  //! \brief Finalizes the element matrices after the numerical integration.
+  //! \param elmInt The local integral object to receive the contributions
+  //! \param[in] time Parameters for nonlinear and time-dependent simulations
+  //! \param[in] iGP Global integration point counter of first point in element
+  //!
+  //! \details When batched integration is enabled, the buffered integration
+  //! point data of the element is evaluated here.
+  virtual bool finalizeElement(LocalIntegral& elmInt,
+                               const TimeDomain& time, size_t iGP);
+
   //! \brief Returns which integrand to be used.
   virtual int getIntegrandType() const;
 
+  //! \brief Defines the matrix-free evaluation mode.
+  //! \param[in] mode \a 'K' to evaluate the internal forces -K*u only,
+  //! \a 'D' to evaluate the diagonal of the stiffness matrix only,
+  //! \a 'R' to evaluate the residual forces, i.e., the external loads
+  //! minus the internal forces, or 0 for the normal evaluation
+  //! \details This affects the RHS_ONLY solution mode only. The setting
+  //! takes effect in the next call to setMode.
+  void setMatrixFreeMode(char mode) { mfMode = mode; }
+
+  //! \brief Toggles caching of the element material stiffness matrices.
+  //! \details When enabled, the element stiffness matrices computed in the
+  //! static solution mode are reused in a subsequent linearized buckling
+  //! analysis, where only the geometric stiffness matrices are then integrated.
+  //! In linear dynamic analysis, the cache is always enabled.
+  void setStiffnessCache(bool on) { KmCache.enable(on); }
+
   //! \brief Returns the initial temperature field.
   const RealFunc* getInitialTemperature() const { return myTemp0; }
   //! \brief Returns the stationary temperature field.
@@ -96,9 +151,19 @@ protected:
                                     const Matrix& B, const Matrix& C,
                                     const Vec3& X, double detJW) const;
 
+  //! \brief Returns whether batched stiffness integration is used.
+  bool useBatchIntegration() const;
+
   RealFunc* myTemp0; //!< Initial temperature field
   RealFunc* myTemp;  //!< Explicit stationary temperature field
 
+  bool sumFact;  //!< If \e true, use sum factorization for the stiffness
+  bool batchInt; //!< If \e true, integrate the stiffness over all points
+  char mfMode;   //!< Matrix-free evaluation mode
+
+  ElmMatCache KmCache;   //!< Cached element material stiffness matrices
+  bool        KmDynamic; //!< If \e true, the cache is filled in dynamic mode
+
 private:
   mutable Vec3Vec* myItgPts; //!< Global Gauss point coordinates
 };
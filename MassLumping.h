@@ -0,0 +1,60 @@
+// $Id$
+//==============================================================================
+//!
+//! \file MassLumping.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author Knut Morten Okstad / SINTEF
+//!
+//! \brief Lumping of consistent element mass matrices.
+//!
+//==============================================================================
+
+#ifndef _MASS_LUMPING_H
+#define _MASS_LUMPING_H
+
+#include "MatVec.h"
+
+class TiXmlElement;
+
+
+/*!
+  \brief Lumping of consistent element mass matrices into diagonal form.
+  \details The element matrices are assumed to have the nodal degrees of
+  freedom ordered consecutively, i.e., \a ndof entries per node. Each nodal
+  component is lumped separately, and couplings between different components
+  (e.g., translations and rotations in eccentric beams) are discarded.
+  The total mass of each component is preserved by all methods.
+*/
+
+namespace MassLumping
+{
+  //! \brief Enum defining the available mass matrix formulations.
+  enum Type
+  {
+    CONSISTENT = 0, //!< Consistent mass matrix (no lumping)
+    ROW_SUM    = 1, //!< Row-sum lumping
+    HRZ        = 2, //!< Diagonal scaling (Hinton-Rock-Zienkiewicz)
+    POSITIVE   = 3  //!< Scaled absolute row-sum, always positive
+  };
+
+  //! \brief Parses the mass lumping type from an XML-element.
+  Type parse(const TiXmlElement* elem);
+  //! \brief Returns the name of a mass lumping type.
+  const char* getName(Type type);
+
+  //! \brief Computes the lumped mass from a consistent element mass matrix.
+  //! \param[in] M The consistent element mass matrix
+  //! \param[out] diag The lumped (diagonal) element mass
+  //! \param[in] type The lumping method to use
+  //! \param[in] ndof Number of degrees of freedom per node
+  bool lump(const Matrix& M, Vector& diag, Type type, size_t ndof = 1);
+  //! \brief Replaces a consistent element mass matrix by its lumped equivalent.
+  //! \param M The element mass matrix to lump
+  //! \param[in] type The lumping method to use
+  //! \param[in] ndof Number of degrees of freedom per node
+  bool lump(Matrix& M, Type type, size_t ndof = 1);
+}
+
+#endif
@@ -0,0 +1,85 @@
+// $Id$
+//==============================================================================
+//!
+//! \file MatrixFreeSolver.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author Knut Morten Okstad / SINTEF
+//!
+//! \brief Matrix-free iterative solver for linear elasticity problems.
+//!
+//==============================================================================
+
+#ifndef _MATRIX_FREE_SOLVER_H
+#define _MATRIX_FREE_SOLVER_H
+
+#include "MatVec.h"
+
+class SIMbase;
+class LinearElasticity;
+
+
+/*!
+  \brief Matrix-free preconditioned conjugate gradient solver.
+  \details The stiffness operator is applied element-by-element through the
+  LinearElasticity integrand, by assembling the internal force vector for a
+  given displacement field into the right-hand-side vector of the model.
+  Thus, the global stiffness matrix is never formed. The preconditioner is
+  either the inverse diagonal of the stiffness matrix (Jacobi), or a Chebyshev
+  polynomial in the Jacobi-preconditioned operator.
+
+  The equations are solved in DOF-ordering, where all constrained DOFs are
+  kept at their prescribed values. Multi-point constraints are not supported.
+*/
+
+class MatrixFreeSolver
+{
+public:
+  //! \brief Enum defining the available preconditioners.
+  enum Preconditioner { JACOBI, CHEBYSHEV };
+
+  //! \brief The constructor initializes the default solver parameters.
+  //! \param sim The FE model to solve for
+  //! \param[in] pc The preconditioner to use
+  MatrixFreeSolver(SIMbase& sim, Preconditioner pc = JACOBI);
+  //! \brief Empty destructor.
+  virtual ~MatrixFreeSolver() {}
+
+  //! \brief Defines the convergence tolerance and maximum number of iterations.
+  void setTolerance(double rtol, int maxit) { relTol = rtol; maxIt = maxit; }
+  //! \brief Defines the polynomial degree of the Chebyshev preconditioner.
+  void setChebyshevDegree(int degree) { chebDeg = degree; }
+
+  //! \brief Solves the static linear elasticity problem.
+  //! \param[out] displ Displacement vector, in DOF-ordering
+  //! \param[out] load External load vector, in DOF-ordering (optional)
+  bool solve(Vector& displ, Vector* load = nullptr);
+
+protected:
+  //! \brief Assembles the right-hand-side vector in the given evaluation mode.
+  //! \param[in] mode Matrix-free evaluation mode of the integrand
+  //! \param[in] u Displacement vector, in DOF-ordering
+  //! \param[out] b The assembled vector, in DOF-ordering
+  bool assemble(char mode, const Vector& u, Vector& b);
+  //! \brief Applies the stiffness operator, \a y = K*x.
+  bool applyOperator(const Vector& x, Vector& y);
+  //! \brief Applies the preconditioner, \a z = P*r.
+  bool precondition(const Vector& r, Vector& z);
+  //! \brief Estimates the largest eigenvalue of the Jacobi-scaled operator.
+  //! \param[in] nIt Number of power iterations
+  bool estimateMaxEigenvalue(int nIt = 10);
+
+private:
+  SIMbase&          model; //!< The FE model to solve for
+  LinearElasticity* elp;   //!< The linear elasticity integrand
+
+  Preconditioner precond;   //!< The preconditioner to use
+  int            chebDeg;   //!< Polynomial degree of Chebyshev preconditioner
+  int            maxIt;     //!< Maximum number of iterations
+  double         relTol;    //!< Relative convergence tolerance
+  double         lambdaMax; //!< Upper eigenvalue bound of D^-1*K
+  Vector         invDiag;   //!< Inverse stiffness matrix diagonal
+};
+
+#endif
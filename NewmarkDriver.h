@@ -15,14 +15,25 @@
 #define _NEWMARK_DRIVER_H
 
 #include "DataExporter.h"
+#include "ElasticBase.h"
+#include "GenAlphaSIM.h"
 #include "TimeStep.h"
+#include "IFEM.h"
 #include "Utilities.h"
 #include "tinyxml.h"
 #include <fstream>
+#include <type_traits>
 
 
 /*!
   \brief Driver for isogeometric FEM analysis of elastodynamic problems.
+  \details The time step size is either fixed, as defined by the time stepping
+  parameters, or adjusted from a local truncation error estimate.
+  In the latter case, a rejected step is re-solved from the complete state
+  of the time integrator at the start of the step, with the step size halved
+  by cut-back until the error is acceptable or the minimum size is reached.
+  For linear problems, the factorized effective system matrix is reused
+  as long as the time step size is unchanged.
 */
 
 template<class Newmark> class NewmarkDriver : public Newmark
@@ -30,7 +41,12 @@ template<class Newmark> class NewmarkDriver : public Newmark
 public:
   //! \brief The constructor forwards to the parent class constructor.
   //! \param sim Reference to the spline FE model
-  NewmarkDriver(SIMbase& sim) : Newmark(sim) { doInitAcc = false; }
+  NewmarkDriver(SIMbase& sim) : Newmark(sim)
+  {
+    doInitAcc = false;
+    errTol = dtMin = dtMax = 0.0;
+    dtFact = 0.0;
+  }
   //! \brief Empty destructor.
   virtual ~NewmarkDriver() {}
 
@@ -44,7 +60,24 @@ protected:
       utl::getAttribute(elem,"initacc",doInitAcc);
       const TiXmlElement* child = elem->FirstChildElement();
       for (; child; child = child->NextSiblingElement())
-        params.parse(child);
+        if (!strcasecmp(child->Value(),"adaptive"))
+        {
+          utl::getAttribute(child,"tol",errTol);
+          utl::getAttribute(child,"min",dtMin);
+          utl::getAttribute(child,"max",dtMax);
+          IFEM::cout <<"\tError-controlled time stepping: tolerance = "
+                     << errTol <<", dt in ["<< dtMin <<","<< dtMax <<"]"
+                     << std::endl;
+          if (errTol > 0.0 && dtMin <= 0.0)
+          {
+            std::cerr <<" *** NewmarkDriver::parse: Error-controlled time"
+                      <<" stepping requires a positive minimum step size."
+                      << std::endl;
+            return false;
+          }
+        }
+        else
+          params.parse(child);
     }
     else if (!strcasecmp(elem->Value(),"postprocessing"))
     {
@@ -81,6 +114,8 @@ public:
     if (doInitAcc && !this->initAcc(ztol,outPrec))
       return 4;
 
+    dtFact = 0.0; // No factorized effective system matrix yet
+
     SIMoptions::ProjectionMap::const_iterator pi = Newmark::opt.project.begin();
     bool doProject  = pi != Newmark::opt.project.end();
     double nextSave = params.time.t + Newmark::opt.dtSave;
@@ -90,18 +125,79 @@ public:
     if (!pointfile.empty())
       os = new std::ofstream(pointfile.c_str());
 
+    // State at the start of current step, for the error-controlled stepping
+    SIMsolution::SerializeMap prevState;
+    Vector prevAcc;
+    double dtAdapt = params.time.dt;
+    bool clipped = false;
+    if (errTol > 0.0)
+      clipped = this->setStepSize(dtAdapt,nextSave);
+
     // Invoke the time-step loop
     int status = 0;
     for (int iStep = 0; status == 0 && this->advanceStep(params);)
     {
-      // Solve the dynamic FE problem at this time step
-      if (this->solveStep(params,SIM::DYNAMIC,ztol,outPrec) != SIM::CONVERGED)
+      if (errTol > 0.0)
+      {
+        prevState.clear();
+        if (!this->serialize(prevState))
+        {
+          status = 5;
+          break;
+        }
+        prevAcc = this->getAcceleration();
+      }
+
+      // Solve the dynamic FE problem at this time step.
+      // With error-controlled stepping, a step with too large error estimate
+      // is re-solved from the saved state with a cut-back step size.
+      SIM::ConvStatus stat = SIM::OK;
+      double eta = 0.0;
+      for (;;)
+      {
+        stat = this->solveStep(params,SIM::DYNAMIC,ztol,outPrec);
+        if (errTol <= 0.0) break;
+
+        eta = 2.0*errTol;
+        if (stat == SIM::CONVERGED)
+          eta = this->errorEstimate(prevAcc,params.time.dt);
+        if (eta <= errTol || 0.5*params.time.dt < dtMin || !params.cutback())
+          break;
+
+        IFEM::cout <<"  ** Rejecting time step "<< params.step
+                   <<", error estimate "<< eta <<", new dt = "<< params.time.dt
+                   << std::endl;
+        if (!this->deSerialize(prevState))
+        {
+          stat = SIM::FAILURE;
+          break;
+        }
+        Newmark::model.updateConfiguration(Newmark::solution.front());
+      }
+
+      if (stat != SIM::CONVERGED)
       {
         status = 5;
         break;
       }
 
-      if (doProject)
+      if (errTol > 0.0)
+      {
+        // Adjust the step size, a step clipped at a save point is not used
+        double fac = eta > 0.0 ? 0.9*cbrt(errTol/eta) : 2.0;
+        if (fac > 2.0) fac = 2.0;
+        if (!clipped || fac < 1.0)
+          dtAdapt = params.time.dt*(fac > 0.25 ? fac : 0.25);
+        if (dtMax > 0.0 && dtAdapt > dtMax)
+          dtAdapt = dtMax;
+        else if (dtAdapt < dtMin)
+          dtAdapt = dtMin;
+      }
+
+      // The projected results are only used at the save points, so there
+      // is no need to recompute the projection at the other time steps
+      bool saveNow = params.hasReached(nextSave);
+      if (doProject && saveNow)
       {
         // Project the secondary results onto the spline basis
         Newmark::model.setMode(SIM::RECOVERY);
@@ -114,7 +210,7 @@ public:
       utl::LogStream log(*os);
       this->dumpResults(params.time.t,log,ptPrec,pointfile.empty());
 
-      if (params.hasReached(nextSave))
+      if (saveNow)
       {
         // Save solution variables to VTF
         if (Newmark::opt.format >= 0)
@@ -138,6 +234,10 @@ public:
         if (nextSave > params.stopTime)
           nextSave = params.stopTime; // Always save the final step
       }
+
+      // Use the error-controlled step size in the next increment
+      if (errTol > 0.0)
+        clipped = this->setStepSize(dtAdapt,nextSave);
     }
 
     if (!pointfile.empty())
@@ -146,6 +246,135 @@ public:
     return status;
   }
 
+  //! \brief Solves the dynamic equilibrium equations at current time step.
+  //! \param param Time stepping parameters
+  //! \param[in] mode Solution mode to use for this step
+  //! \param[in] ztol Truncate norm values smaller than this to zero
+  //! \param[in] outPrec Number of digits after the decimal point in norm print
+  //!
+  //! \details For linear problems, where the effective system matrix only
+  //! depends on the time step size, the matrix is assembled and factorized
+  //! by the parent class method in the first step only, and whenever the step
+  //! size changes. The other steps assemble the right-hand-side vector only,
+  //! and solve with the existing factorization. This is done for the plain
+  //! Newmark integrator only. Subclasses of NewmarkSIM, such as GenAlphaSIM,
+  //! always use their own \a solveStep method.
+  virtual SIM::ConvStatus solveStep(TimeStep& param,
+                                    SIM::SolutionMode mode = SIM::DYNAMIC,
+                                    double ztol = 1.0e-8,
+                                    std::streamsize outPrec = 0)
+  {
+    Newmark::model.setMode(mode);
+    const IntegrandBase* prob = Newmark::model.getProblem();
+    if (!std::is_same<Newmark,NewmarkSIM>::value ||
+        !prob || prob->getIntegrationPrm(3) <= 0.0)
+      return this->Newmark::solveStep(param,mode,ztol,outPrec);
+
+    if (fabs(param.time.dt-dtFact) > 1.0e-12*param.time.dt)
+    {
+      // New time step size, assemble and factorize the effective matrix
+      SIM::ConvStatus stat = this->Newmark::solveStep(param,mode,ztol,outPrec);
+      dtFact = stat == SIM::CONVERGED ? param.time.dt : 0.0;
+      return stat;
+    }
+
+    param.iter = 0;
+    if (!this->predictStep(param))
+      return SIM::FAILURE;
+
+    if (!Newmark::model.updateDirichlet(param.time.t,
+                                       &Newmark::solution.front()))
+      return SIM::FAILURE;
+
+    if (!Newmark::model.assembleSystem(param.time,Newmark::solution,false))
+      return SIM::FAILURE;
+
+    if (!Newmark::model.solveSystem(Newmark::linsol,Newmark::msgLevel-1,
+                                    nullptr,nullptr,false))
+      return SIM::FAILURE;
+
+    // The solution of a linear problem is exact after one iteration
+    if (!this->correctStep(param,true) || !Newmark::model.updateDirichlet())
+      return SIM::FAILURE;
+
+    return SIM::CONVERGED;
+  }
+
+  //! \brief Calculates initial accelerations.
+  //! \param[in] ztol Truncate norm values smaller than this to zero
+  //! \param[in] outPrec Number of digits after the decimal point in norm print
+  //!
+  //! \details If the integrand uses a lumped mass matrix, the mass is
+  //! assembled into a vector and the accelerations are found by a diagonal
+  //! solve. Otherwise, and always for the generalized-alpha method,
+  //! which needs to update its own state vectors, the parent class method
+  //! is invoked.
+  bool initAcc(double ztol = 1.0e-8, std::streamsize outPrec = 0)
+  {
+    const ElasticBase* elp =
+      dynamic_cast<const ElasticBase*>(Newmark::model.getProblem());
+    if (!elp || elp->getMassLumping() == MassLumping::CONSISTENT ||
+        dynamic_cast<const GenAlphaSIM*>(this))
+      return this->Newmark::initAcc(ztol,outPrec);
+
+    IFEM::cout <<"\n  Calculating initial accelerations, using "
+               << MassLumping::getName(elp->getMassLumping())
+               <<" mass"<< std::endl;
+
+    // Assemble the load vector and the lumped mass vector, no system matrix
+    Vector load, mass;
+    Newmark::model.setMode(SIM::MASS_ONLY);
+    if (!Newmark::model.initSystem(Newmark::opt.solver,0,2) ||
+        !Newmark::model.assembleSystem(params.time,Newmark::solution) ||
+        !Newmark::model.extractLoadVec(load,0) ||
+        !Newmark::model.extractLoadVec(mass,1))
+      return false;
+
+    // Solve the diagonal system, constrained DOFs have zero mass
+    Vector& acc = Newmark::solution.back();
+    acc.resize(load.size(),true);
+    for (size_t i = 1; i <= load.size() && i <= mass.size(); i++)
+      if (mass(i) > 0.0)
+        acc(i) = load(i) / mass(i);
+
+    // Restore the equation system for the time integration
+    this->initEqSystem();
+    return true;
+  }
+
+  //! \brief Defines the step size of the next time increment.
+  //! \param[in] dt The error-controlled time step size
+  //! \param[in] nextSave Time of the next save point
+  //! \return \e true if the step size was clipped to not pass a save point
+  //!
+  //! \details The step size is assigned before the time increment, such that
+  //! the time and previous step size are updated by the TimeStep object.
+  bool setStepSize(double dt, double nextSave)
+  {
+    double tEnd = params.stopTime;
+    if (nextSave > params.time.t && nextSave < tEnd) tEnd = nextSave;
+    bool clipped = params.time.t + dt > tEnd && tEnd > params.time.t;
+    params.time.dt = clipped ? tEnd - params.time.t : dt;
+    return clipped;
+  }
+
+  //! \brief Estimates the local truncation error of the last time step.
+  //! \param[in] prevAcc Accelerations at the start of the time step
+  //! \param[in] dt The time step size
+  //!
+  //! \details The estimate of Zienkiewicz and Xie is used, i.e., the norm of
+  //! (beta-1/6)*dt^2*(a_{n+1}-a_n), relative to the displacement norm.
+  //! The Newmark parameter beta is that of the parent class, which for the
+  //! generalized-alpha method is derived from the spectral radius.
+  double errorEstimate(const Vector& prevAcc, double dt) const
+  {
+    Vector err(this->getAcceleration());
+    err.add(prevAcc,-1.0);
+    double uNorm = Newmark::solution.front().norm2();
+    return fabs(Newmark::beta-1.0/6.0)*dt*dt*err.norm2() /
+      (uNorm > 0.0 ? uNorm : 1.0);
+  }
+
   //! \brief Accesses the projected solution.
   const Vector& getProjection() const { return proSol; }
 
@@ -158,6 +387,11 @@ private:
 
   std::string pointfile; //!< Name of output file for point results
   bool        doInitAcc; //!< If \e true, calculate initial accelerations
+
+  double errTol; //!< Local truncation error tolerance (0 = fixed step size)
+  double dtMin;  //!< Minimum time step size in error-controlled stepping
+  double dtMax;  //!< Maximum time step size in error-controlled stepping
+  double dtFact; //!< Time step size of the factorized effective matrix
 };
 
 #endif
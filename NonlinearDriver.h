@@ -26,6 +26,8 @@ class DataExporter;
   It reimplements the \a solutionNorms method to also compute the energy norm
   and other norms of the stress field. In addition, it has the method
   \a solveProblem to manage the pseudo-time step loop.
+  Optionally, the load steps can be solved by modified Newton or quasi-Newton
+  iterations, which reuse the factorized tangent matrix of the first iteration.
 */
 
 class NonlinearDriver : public NonLinSIM
@@ -79,10 +81,117 @@ public:
   //! \brief Flag that we are doing a linear analysis only.
   void setLinear() { iteNorm = NONE; }
 
+  //! \brief Defines the step interval for secondary solution recovery.
+  //! \details The solution norms, projections and max values are then only
+  //! computed at every \a inc step, and at the save and dump points.
+  void setRecoveryInterval(int inc) { recInc = inc; }
+
+protected:
+  //! \brief Checks whether secondary results are needed at current step.
+  //! \param[in] nextSave Time of next result save point
+  //! \param[in] nextDump Time of next ASCII result dump point
+  bool needsRecovery(double nextSave, double nextDump) const;
+
+  //! \brief Solves the problem by arc-length continuation.
+  //! \param iStep Running VTF result step counter
+  //! \param writer HDF5 results exporter
+  //! \param oss Output stream for additional ASCII result output
+  //! \param[in] dtDump Time increment for dump of ASCII results
+  //! \param[in] zero_tol Truncate norm values smaller than this to zero
+  //! \param[in] normPrec Number of digits after the decimal point in norms
+  //! \param[in] outPrec Number of digits after the decimal point in output
+  int solveArcLength(int& iStep, DataExporter* writer, utl::LogStream* oss,
+                     double dtDump, double zero_tol,
+                     std::streamsize normPrec, std::streamsize outPrec);
+  //! \brief Checks for prescribed displacements in arc-length continuation.
+  bool hasPrescribedDisplacements() const;
+
+  //! \brief Post-processes the results of a converged step.
+  //! \param iStep Running VTF result step counter
+  //! \param writer HDF5 results exporter
+  //! \param oss Output stream for additional ASCII result output
+  //! \param[in] dtDump Time increment for dump of ASCII results
+  //! \param nextDump Time of next ASCII result dump point
+  //! \param nextSave Time of next result save point
+  //! \param[in] outPrec Number of digits after the decimal point in output
+  //! \return 0 on success, otherwise a non-zero error code
+  int saveResults(int& iStep, DataExporter* writer, utl::LogStream* oss,
+                  double dtDump, double& nextDump, double& nextSave,
+                  std::streamsize outPrec);
+
+  //! \brief Extrapolates the solution from the previous converged steps.
+  //! \param[in] t Time of the current step
+  bool predictSolution(double t);
+  //! \brief Stores the current converged solution for the predictor.
+  //! \param[in] t Time of the converged solution
+  void storeSolution(double t);
+
+  //! \brief Solves the nonlinear equations at current load step.
+  //! \param param Time stepping parameters
+  //! \param[in] mode Solution mode to use for this step
+  //! \param[in] zero_tolerance Truncate norm values smaller than this to zero
+  //! \param[in] outPrec Number of digits after the decimal point in norm print
+  //!
+  //! \details If a modified Newton or quasi-Newton iteration mode is selected,
+  //! this is tried first. If it fails to converge, the step is restarted
+  //! from its initial state using the full Newton iterations of the parent
+  //! class, before a cut-back of the step size is attempted.
+  //! If a line search is requested, the Newton iterations are done here too.
+  virtual SIM::ConvStatus solveStep(TimeStep& param, SIM::SolutionMode mode,
+                                    double zero_tolerance,
+                                    std::streamsize outPrec);
+
 private:
+  //! \brief Solves the nonlinear equations with a reused tangent matrix.
+  //! \param param Time stepping parameters
+  //! \details The factorization of the tangent matrix is kept as long as the
+  //! convergence rate is acceptable. In the quasi-Newton mode, the iteration
+  //! steps are in addition improved by Broyden updates of the inverse tangent.
+  SIM::ConvStatus solveReusedTangent(TimeStep& param);
+  //! \brief Performs a line search along the given iteration step.
+  //! \param param Time stepping parameters
+  //! \param[in] du The iteration step to search along
+  //! \param residual Residual force vector at the start point, and at the
+  //! accepted point on exit
+  //! \param[out] alpha Accepted step length
+  //! \param[in] newTangent If \e true, also assemble the tangent matrix
+  bool lineSearch(TimeStep& param, const Vector& du,
+                  Vector& residual, double& alpha, bool newTangent);
+  //! \brief Assembles and solves the linear arc-length equation systems.
+  //! \param time Current load factor (pseudo time)
+  //! \param[out] dur Solution for the residual forces
+  //! \param[out] duq Solution for the reference load vector
+  //! \param[out] rNorm L2-norm of the residual forces
+  //! \param[out] qNorm L2-norm of the reference load vector
+  bool arcLengthSolve(TimeDomain& time, Vector& dur, Vector& duq,
+                      double& rNorm, double& qNorm);
+
   TimeStep params; //!< Time stepping parameters
   char     calcEn; //!< Flag for calculation of solution energy norm
   Matrix   proSol; //!< Projected secondary solution
+  int      recInc; //!< Step interval for secondary solution recovery
+  bool     doRecovery; //!< If \e true, compute secondary results at this step
+
+  char   iterMode; //!< Iteration mode ('N'=Newton, 'M'=modified, 'Q'=quasi)
+  int    maxReuse; //!< Max number of iterations using the same tangent
+  size_t maxUpd;   //!< Max number of quasi-Newton updates stored
+  double rateLim;  //!< Residual reduction limit for reusing the tangent
+  int    maxLS;    //!< Max number of residual evaluations in line search
+  double lsTol;    //!< Residual energy reduction tolerance in line search
+  double lsMin;    //!< Minimum step length in line search
+
+  size_t    predOrder; //!< Polynomial order of the solution predictor
+  Vectors   predSol;   //!< Previous converged solutions for the predictor
+  RealArray predTime;  //!< Times of the previous converged solutions
+
+  double arcLen;   //!< Initial arc length (0 = load-controlled stepping)
+  double arcMin;   //!< Minimum arc length
+  double arcMax;   //!< Maximum arc length
+  double arcPsi;   //!< Load scaling parameter of the arc-length constraint
+  double arcTol;   //!< Relative residual tolerance in arc-length iterations
+  int    arcIts;   //!< Desired number of iterations per arc-length step
+  int    arcMaxIt; //!< Max number of iterations per arc-length step
+  int    arcSteps; //!< Max number of arc-length steps
 };
 
 #endif
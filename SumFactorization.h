@@ -0,0 +1,53 @@
+// $Id$
+//==============================================================================
+//!
+//! \file SumFactorization.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author Knut Morten Okstad / SINTEF
+//!
+//! \brief Sum-factorized stiffness integration for tensor-product elements.
+//!
+//==============================================================================
+
+#ifndef _SUM_FACTORIZATION_H
+#define _SUM_FACTORIZATION_H
+
+#include "MatVec.h"
+#include "Vec3.h"
+
+
+/*!
+  \brief Sum-factorized integration of 3D continuum element stiffness matrices.
+  \details For elements with a tensor-product basis, integrated with a
+  tensor-product quadrature, the element stiffness matrix can be formed by
+  contracting one parameter direction at a time, reducing the cost per element
+  from O(p<SUP>9</SUP>) to O(p<SUP>7</SUP>).
+
+  The univariate basis functions are recovered from the trivariate basis
+  function values at the integration points, using the partition of unity
+  property, and their parametric derivatives are computed by exact
+  differentiation of the interpolating polynomial through the 1D quadrature
+  points. This requires the basis to be polynomial over each element,
+  i.e., non-rational splines, and at least \a p+1 points in each direction.
+  The inverse Jacobian at each point is then recovered from the given
+  Cartesian basis function gradients.
+*/
+
+namespace SumFactorization
+{
+  //! \brief Integrates the material stiffness matrix of a 3D element.
+  //! \param EK Element matrix to receive the stiffness contributions
+  //! \param[in] N Basis function values, one row per integration point
+  //! \param[in] dNdX Basis function gradients, one row per integration point
+  //! \param[in] Xi Element-local parameters of each integration point
+  //! \param[in] D Constitutive matrices times integration point volume,
+  //! where \a D[(s*6+t)*nPt+q] is component (s,t) at point \a q
+  //! \return \e false if the element does not have the required
+  //! tensor-product structure, in which case \a EK is left unchanged
+  bool stiffness(Matrix& EK, const Matrix& N, const Matrix& dNdX,
+                 const Vec3Vec& Xi, const RealArray& D);
+}
+
+#endif